@@ -11,10 +11,28 @@
 #define ERROR_DATA_NOT_FOUND    (-3)
 #define ERROR_PHASE_COUNT       (-4)
 #define ERROR_DIVIDE_BYZERO     (-5)
+#define ERROR_OUT_OF_MEMORY     (-6)
 
 // --- Macro for print the error ---
 #define REPORT_ERROR(message) fprintf(stderr, "Error: %s\n",message)
 
+// --- Table set limits ---
+#define MAX_TABLE_SETS          (8)  // NOM, NEC, IEC... loaded at the same time
+#define MAX_CONDUCTORS_PER_SET  (20)
+#define MAX_TEMP_FACTORS_PER_SET (20)
+#define MAX_NCOND_FACTORS_PER_SET (20)
+#define MAX_CONDUITS_PER_SET    (30)
+#define TABLE_SET_ALL           (-1) // Circuit record asks for every loaded set (comparison report)
+
+// --- Design limits ---
+#define MAX_VOLTAGE_DROP_PERCENT (3.0f)  // Recommended voltage drop limit
+#define MAX_CONDUIT_FILL_PERCENT (40.0f) // Conduit fill limit for more than 2 conductors
+
+// --- Energy loss mode ---
+#define ENERGY_BLOCK_HOURS      (1024) // Profile values reduced per block, 4 KB of floats stays in L1 cache
+#define HOURS_PER_YEAR          (8760)
+#define HOURS_PER_LEAP_YEAR     (8784)
+
 // --- Structure Definitions ---
 
 // Structures for a conductor
@@ -47,12 +65,51 @@ typedef struct s_conduit{
     float sc_internal_area_mm2;
 }Conduit;
 
+// Structure for a named table set (NOM, NEC, IEC...). Each set is a slice [first, first + count) of the global lists.
+typedef struct s_table_set{
+    char sts_name[16];
+    int sts_conductor_first;
+    int sts_conductor_count;
+    int sts_temp_first;
+    int sts_temp_count;
+    int sts_ncond_first;
+    int sts_ncond_count;
+    int sts_conduit_first;
+    int sts_conduit_count;
+}TableSet;
+
+// Structure for one circuit of a batch file
+typedef struct s_circuit_record{
+    char scr_label[32];
+    int scr_table_set_id; // Index in g_table_set_g_list, or TABLE_SET_ALL
+    float scr_power_watts;
+    float scr_voltage_volts;
+    float scr_power_factor;
+    int scr_phase_count;
+    float scr_circuit_length_meters;
+    int scr_ambient_temperature;
+    int scr_conductor_count;
+    char scr_insulation_type[32];
+    int scr_temp_rating;
+    char scr_conduit_type[32];
+    float scr_conduit_diameter;
+}CircuitRecord;
+
+// Structure for the gauge independent part of an hourly load profile
+typedef struct s_load_profile_summary{
+    double slps_sum_power_sq; // Sum of P^2 over every hour (W^2), I^2 is this times (amps per watt)^2
+    float slps_peak_power_watts; // Largest |P| of the profile
+    int slps_hour_count;
+}LoadProfileSummary;
+
 // --- Function Prototypes ---
 // For data loading
-int load_ampacity_table_data(const char *arg_file_name_ptr); // Function to load the ampacity table
-int load_temperature_correction(const char *arg_file_name_ptr); // Function to load the temperature correction factors.
-int load_nconductor_factor(const char *arg_file_name_ptr); // Function to load the number of conductor, correction factor.
-int load_conduit_fill_data(const char *arg_file_name_ptr); // function to load the properties of conduit.
+int load_table_sets(const char *arg_file_name_ptr); // Function to load every table set listed in the manifest.
+int load_table_set(const char *arg_set_name_ptr, const char *arg_ampacity_file_ptr, const char *arg_temp_file_ptr, const char *arg_ncond_file_ptr, const char *arg_conduit_file_ptr); // Returns the new set id.
+int load_ampacity_table_data(const char *arg_file_name_ptr, int arg_set_id); // Function to load the ampacity table
+int load_temperature_correction(const char *arg_file_name_ptr, int arg_set_id); // Function to load the temperature correction factors.
+int load_nconductor_factor(const char *arg_file_name_ptr, int arg_set_id); // Function to load the number of conductor, correction factor.
+int load_conduit_fill_data(const char *arg_file_name_ptr, int arg_set_id); // function to load the properties of conduit.
 
 // Calculation base
 float calculate_load_current_amps(float arg_power_watts, float arg_voltage_volts, float arg_power_factor, int arg_phase_count); // Initial current calculation
@@ -60,32 +117,48 @@ float calculate_adjusted_current_amps(float arg_load_current_amps, float arg_tem
 float calculate_voltage_drop_volts(float arg_load_Current_amps, float arg_circuit_lenght_meters, float arg_resistance_per_km, float arg_reactance_per_km, float arg_power_factor, int arg_phase_count);
 
 // Data retrieval
-float get_temp_correction_factor(int arg_ambient_temp);
-float get_ncond_adj_factor(int arg_conductor_count);
-float get_conductor_resistance_km(int arg_gauge_awg_kcmil);
-float get_conductor_reactance_km(int arg_gauge_awg_kcmil);
-float get_conductor_mm2(int arg_gauge_awg_kcmil);
-float get_conduit_area(const char *arg_conduit_type_ptr, float arg_conduit_diameter_nominal_inches);
+int get_table_set_id(const char *arg_set_name_ptr);
+float get_temp_correction_factor(int arg_set_id, int arg_ambient_temp);
+float get_ncond_adj_factor(int arg_set_id, int arg_conductor_count);
+float get_conductor_resistance_km(int arg_set_id, int arg_gauge_awg_kcmil);
+float get_conductor_reactance_km(int arg_set_id, int arg_gauge_awg_kcmil);
+float get_conductor_mm2(int arg_set_id, int arg_gauge_awg_kcmil);
+float get_conduit_area(int arg_set_id, const char *arg_conduit_type_ptr, float arg_conduit_diameter_nominal_inches);
 
 // Selection and validation
-int get_suggested_gauge_awg_kcmil(float arg_adjusted_current_amps, const char *arg_insulation_type_ptr, int arg_temp_rating);
-int check_conduit_fill(float arg_conductor_area, int arg_conductor_count, const char *arg_conduit_type_ptr, float arg_conduit_diameter_nominal_inches);
+int get_suggested_gauge_awg_kcmil(int arg_set_id, float arg_adjusted_current_amps, const char *arg_insulation_type_ptr, int arg_temp_rating);
+int check_conduit_fill(int arg_set_id, float arg_conductor_area, int arg_conductor_count, const char *arg_conduit_type_ptr, float arg_conduit_diameter_nominal_inches);
+const char *format_gauge_awg_kcmil(int arg_gauge_awg_kcmil, char *arg_buffer_ptr, size_t arg_buffer_size);
+
+// Batch mode
+int run_circuit_batch(const char *arg_input_file_ptr, const char *arg_report_file_ptr);
+int evaluate_circuit_record(const CircuitRecord *arg_record_ptr, int arg_set_id, FILE *arg_report_ptr);
+
+// Energy loss mode
+int run_energy_loss_batch(const char *arg_input_file_ptr, const char *arg_report_file_ptr);
+int read_long_line(FILE *arg_file_ptr, char **arg_buffer_ptr, size_t *arg_capacity_ptr); // SUCCESS, ERROR_DATA_NOT_FOUND at end of file or ERROR_OUT_OF_MEMORY
+void reduce_load_profile_block(const float *arg_block_ptr, int arg_count, LoadProfileSummary *arg_summary_ptr);
+int evaluate_energy_loss(const char *arg_label_ptr, int arg_set_id, const LoadProfileSummary *arg_summary_ptr, float arg_amps_per_watt, float arg_voltage_volts, float arg_power_factor, int arg_phase_count, float arg_circuit_length_meters, FILE *arg_report_ptr);
 
 // --- Global variables ---
-Conductor g_conductor_data_g_list[20]; // General structure filled with DATA from CSV files, max. 20 types of conductor.
-int g_conductor_count = 0; // For the number of conductors in the csv file.
+// Every table set shares the same lists; a set only keeps where its rows start and how many there are.
+TableSet g_table_set_g_list[MAX_TABLE_SETS];
+int g_table_set_count = 0;
 
-TempCorrectionFactor g_temp_factors_g_list[20]; // General structure filled with DATA from CSV file, max 20 types of factors
-int g_temp_correction_count = 0; // For the number of correction factors in the CSV file
+Conductor g_conductor_data_g_list[MAX_TABLE_SETS * MAX_CONDUCTORS_PER_SET]; // General structure filled with DATA from CSV files, max. 20 types of conductor per set.
+int g_conductor_count = 0; // For the number of conductors in the csv files.
 
-NumCondFactor g_ncond_adj_g_list[20]; // General structure filled with DATA from CSV file, max 20 types of factors
-int g_ncond_adj_count = 0; // For the number of correction factors in the CSV file.
+TempCorrectionFactor g_temp_factors_g_list[MAX_TABLE_SETS * MAX_TEMP_FACTORS_PER_SET]; // General structure filled with DATA from CSV files, max 20 types of factors per set
+int g_temp_correction_count = 0; // For the number of correction factors in the CSV files
 
-Conduit g_conduit_data_g_list[30]; // General structure filled with DATA from CSV file, max 20 types of factors
+NumCondFactor g_ncond_adj_g_list[MAX_TABLE_SETS * MAX_NCOND_FACTORS_PER_SET]; // General structure filled with DATA from CSV files, max 20 types of factors per set
+int g_ncond_adj_count = 0; // For the number of correction factors in the CSV files.
+
+Conduit g_conduit_data_g_list[MAX_TABLE_SETS * MAX_CONDUITS_PER_SET]; // General structure filled with DATA from CSV files, max 30 conduits per set
 int g_conduit_count = 0;
 
 // --- Main Function ---
-int main() {
+int main(int argc, char *argv[]) {
     // Local variable for user input
     float local_power_watts; // Watts imput
     float local_voltage_volts;
@@ -108,39 +181,62 @@ int main() {
     int local_suggested_gauge_awg_kcmil;
     int return_code;    // To return values from functions.
     int local_conduit_fill_check_result;
+    int local_set_id = 0; // Table set used for this circuit (0 = first set in the manifest)
+    char local_set_name[16];
+    char local_gauge_label[24];
 
     // --- A little presentation ---
     printf("\n\nElectrical Conductor Selection Program (NOM-001-SEDE-2012)\n");
     printf("----------------CS50 PROJECT by @Horfezyn----------------\n\n");
 
     // --- Data loading ---
-    printf("--- Loading NOM Data ---\n");
+    printf("--- Loading Table Sets ---\n");
 
-    return_code = load_ampacity_table_data("ampacity_data.csv");
+    return_code = load_table_sets("table_sets.csv");
     if (return_code != SUCCESS){
-        printf("Error loading ampacity data. Exiting program...");
+        printf("Error loading table sets. Exiting program...");
         return return_code;
     }
+    printf("--- Data Loading Complete ---\n\n");
 
-    return_code = load_temperature_correction("temp_correction_data.csv");
-    if (return_code != SUCCESS){
-        printf("Error loading temperature correction data. Exiting program...");
-        return return_code;
-    }
-    return_code = load_nconductor_factor("num_cond_adj_data.csv");
-    if (return_code != SUCCESS){
-        printf("Error loading number of conductor adjustmen data. Exiting program...");
-        return return_code;
+    // --- Energy loss mode: wiring.exe --energy profiles.csv report.csv ---
+    if (argc >= 2 && strcmp(argv[1], "--energy") == 0) {
+        if (argc < 4) {
+            REPORT_ERROR("Missing load profiles or report file. Usage: wiring.exe --energy profiles.csv report.csv");
+            return ERROR_INVALID_INPUT;
+        }
+        return run_energy_loss_batch(argv[2], argv[3]);
     }
-    return_code = load_conduit_fill_data("conduit_fill_data.csv");
-    if (return_code != SUCCESS){
-        printf("Error loading conduit fill data. Exiting program...");
-        return return_code;
+
+    // --- Batch mode: wiring.exe circuits.csv report.csv ---
+    if (argc >= 2) {
+        if (argc < 3) {
+            REPORT_ERROR("Missing report file. Usage: wiring.exe circuits.csv report.csv");
+            return ERROR_INVALID_INPUT;
+        }
+        return run_circuit_batch(argv[1], argv[2]);
     }
-    printf("--- Data Loading Complete ---\n\n");
 
     // --- User Input ---
     printf("--- Enter Circuit Parameters ---\n");
+    if (g_table_set_count > 1) {
+        do{
+            printf("Enter standard (");
+            for (int i = 0; i < g_table_set_count; i++) {
+                printf("%s%s", i > 0 ? ", " : "", g_table_set_g_list[i].sts_name);
+            }
+            printf("): ");
+            if (scanf("%15s", local_set_name) != 1) {
+                local_set_id = ERROR_DATA_NOT_FOUND;
+                while (getchar() != '\n');
+            } else {
+                local_set_id = get_table_set_id(local_set_name);
+            }
+            if (local_set_id < 0) {
+                REPORT_ERROR("Unknown standard. Please enter one of the loaded table sets.");
+            }
+        } while (local_set_id < 0);
+    }
     do{
         printf("Enter power (Watts, e.g., 10000): ");
         if (scanf("%f", &local_power_watts) != 1) {
@@ -235,12 +331,12 @@ int main() {
     printf("Calculated Load Current (Ib): %.2f Amps\n", local_load_current_amps);
 
     // Correction factors
-    local_temp_correction_factor = get_temp_correction_factor(local_ambient_temperature);
+    local_temp_correction_factor = get_temp_correction_factor(local_set_id, local_ambient_temperature);
     if (local_temp_correction_factor < 0){
         printf("Error: Temperature correction factor not found for %dC. Error code: %d. Exiting\n", local_ambient_temperature, (int)local_temp_correction_factor);
         return (int) local_temp_correction_factor;
     }
-    local_num_cond_adjustment_factor = get_ncond_adj_factor(local_conductor_count);
+    local_num_cond_adjustment_factor = get_ncond_adj_factor(local_set_id, local_conductor_count);
     if (local_num_cond_adjustment_factor < 0){
         printf("Error: Number of conductors adjustment factor not found for %d conductors. Error code: %d. Exiting \n", local_conductor_count, (int)local_num_cond_adjustment_factor);
         return (int) local_num_cond_adjustment_factor;
@@ -255,27 +351,17 @@ int main() {
     printf("Adjusted Design Current (Iz): %.2f Amps\n", local_adjusted_current_amps);
 
     // Suggested gauge
-    local_suggested_gauge_awg_kcmil = get_suggested_gauge_awg_kcmil(local_adjusted_current_amps, local_insulation_type, local_insulation_temperature_rating);
-    printf("Suggested Conductor Gauge: ");
-    if (local_suggested_gauge_awg_kcmil == 110) {
-        printf("1/0 AWG\n");
-    } else if (local_suggested_gauge_awg_kcmil == 120) {
-        printf("2/0 AWG\n");
-    } else if (local_suggested_gauge_awg_kcmil == 130) {
-        printf("3/0 AWG\n");
-    } else if (local_suggested_gauge_awg_kcmil == 140) {
-        printf("4/0 AWG\n");
-    } else if (local_suggested_gauge_awg_kcmil >= 250) {
-        printf("%d kcmil\n", local_suggested_gauge_awg_kcmil);
-    } else if (local_suggested_gauge_awg_kcmil > 0) {
-        printf("%d AWG\n", local_suggested_gauge_awg_kcmil);
+    printf("Action: Getting suggested gauge for %.2f Amps with insulation %s and temperature rating %dC (%s tables).\n", local_adjusted_current_amps, local_insulation_type, local_insulation_temperature_rating, g_table_set_g_list[local_set_id].sts_name);
+    local_suggested_gauge_awg_kcmil = get_suggested_gauge_awg_kcmil(local_set_id, local_adjusted_current_amps, local_insulation_type, local_insulation_temperature_rating);
+    if (local_suggested_gauge_awg_kcmil > 0) {
+        printf("Suggested Conductor Gauge: %s\n", format_gauge_awg_kcmil(local_suggested_gauge_awg_kcmil, local_gauge_label, sizeof(local_gauge_label)));
     }
 
     // Propierties for the conductor calculated.
-    if (local_suggested_gauge_awg_kcmil > 0 || local_suggested_gauge_awg_kcmil == 110 || local_suggested_gauge_awg_kcmil == 120 || local_suggested_gauge_awg_kcmil == 130 || local_suggested_gauge_awg_kcmil == 140) { // Check for valid gauge returned
-        float conductor_area = get_conductor_mm2(local_suggested_gauge_awg_kcmil);
-        float conductor_resistance = get_conductor_resistance_km(local_suggested_gauge_awg_kcmil);
-        float conductor_reactance = get_conductor_reactance_km(local_suggested_gauge_awg_kcmil);
+    if (local_suggested_gauge_awg_kcmil > 0) { // Check for valid gauge returned
+        float conductor_area = get_conductor_mm2(local_set_id, local_suggested_gauge_awg_kcmil);
+        float conductor_resistance = get_conductor_resistance_km(local_set_id, local_suggested_gauge_awg_kcmil);
+        float conductor_reactance = get_conductor_reactance_km(local_set_id, local_suggested_gauge_awg_kcmil);
 
         if (conductor_area != (float)ERROR_DATA_NOT_FOUND && conductor_resistance != (float)ERROR_DATA_NOT_FOUND && conductor_reactance != (float)ERROR_DATA_NOT_FOUND) {
             printf("\n Properties for selected conductor: \n");
@@ -288,16 +374,16 @@ int main() {
 
             if (local_voltage_drop_volts >= 0) { // Check for calculation errors
                 printf("Calculated Voltage Drop: %.2f Volts\n\n", local_voltage_drop_volts);
-                float max_allowed_vd = local_voltage_volts * 0.03f; // 3% voltage drop
+                float max_allowed_vd = local_voltage_volts * MAX_VOLTAGE_DROP_PERCENT / 100.0f;
                 if (local_voltage_drop_volts > max_allowed_vd) {
-                    printf("WARNING: Voltage drop (%.2fV) exceeds the recommended 3%% limit (%.2fV).\n", local_voltage_drop_volts, max_allowed_vd);
+                    printf("WARNING: Voltage drop (%.2fV) exceeds the recommended %.0f%% limit (%.2fV).\n", local_voltage_drop_volts, MAX_VOLTAGE_DROP_PERCENT, max_allowed_vd);
                 }
             } else {
                 printf("Error calculating voltage drop. Error code: %d.\n", (int)local_voltage_drop_volts);
             }
 
             // Conduit fill check
-            local_conduit_fill_check_result = check_conduit_fill(conductor_area, local_conductor_count, local_conduit_type, local_conduit_diameter);
+            local_conduit_fill_check_result = check_conduit_fill(local_set_id, conductor_area, local_conductor_count, local_conduit_type, local_conduit_diameter);
 
         } else {
             printf("Could not retrieve all properties for the suggested conductor gauge.\n");
@@ -317,19 +403,114 @@ int main() {
 
 // --- Function Implementations (The hard part) ---
 
+// Table sets manifest CSV: Standard,AmpacityFile,TempCorrectionFile,NumCondAdjFile,ConduitFillFile
+int load_table_sets(const char *arg_file_name_ptr){
+    FILE *file_ptr = fopen(arg_file_name_ptr, "r");
+    if (!file_ptr){ // No manifest, keep the original NOM tables
+        printf("Action: %s not found, loading default NOM tables.\n", arg_file_name_ptr);
+        int set_id = load_table_set("NOM", "ampacity_data.csv", "temp_correction_data.csv", "num_cond_adj_data.csv", "conduit_fill_data.csv");
+        return set_id < 0 ? set_id : SUCCESS;
+    }
+
+    char line[512];
+    fgets(line, sizeof(line), file_ptr); // Skip header
+
+    g_table_set_count = 0;
+    g_conductor_count = 0;
+    g_temp_correction_count = 0;
+    g_ncond_adj_count = 0;
+    g_conduit_count = 0;
+    while (fgets(line, sizeof(line), file_ptr)){
+        char set_name[16];
+        char ampacity_file[128];
+        char temp_file[128];
+        char ncond_file[128];
+        char conduit_file[128];
+
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '\0') {
+            continue; // Blank line
+        }
+        if (sscanf(line, "%15[^,],%127[^,],%127[^,],%127[^,],%127[^,]", set_name, ampacity_file, temp_file, ncond_file, conduit_file) != 5){
+            REPORT_ERROR("Invalid format in table sets manifest: expected 5 columns.");
+            fclose(file_ptr);
+            return ERROR_INVALID_INPUT;
+        }
+        int set_id = load_table_set(set_name, ampacity_file, temp_file, ncond_file, conduit_file);
+        if (set_id < 0){
+            fclose(file_ptr);
+            return set_id;
+        }
+    }
+    fclose(file_ptr);
+
+    if (g_table_set_count == 0){
+        REPORT_ERROR("No table sets found in the manifest.");
+        return ERROR_DATA_NOT_FOUND;
+    }
+    printf("Action: Loaded %d table sets from %s.\n", g_table_set_count, arg_file_name_ptr);
+    return SUCCESS;
+}
+
+// One table set, its rows are appended after the rows of the sets already loaded
+int load_table_set(const char *arg_set_name_ptr, const char *arg_ampacity_file_ptr, const char *arg_temp_file_ptr, const char *arg_ncond_file_ptr, const char *arg_conduit_file_ptr){
+    if (g_table_set_count >= MAX_TABLE_SETS){
+        REPORT_ERROR("Too many table sets.");
+        return ERROR_INVALID_INPUT;
+    }
+    if (get_table_set_id(arg_set_name_ptr) >= 0){
+        REPORT_ERROR("Duplicated table set name.");
+        return ERROR_INVALID_INPUT;
+    }
+
+    int set_id = g_table_set_count;
+    TableSet *set_ptr = &g_table_set_g_list[set_id];
+    memset(set_ptr, 0, sizeof(*set_ptr));
+    strncpy(set_ptr->sts_name, arg_set_name_ptr, sizeof(set_ptr->sts_name) - 1);
+    printf("Action: Loading %s tables.\n", set_ptr->sts_name);
+
+    int return_code = load_ampacity_table_data(arg_ampacity_file_ptr, set_id);
+    if (return_code == SUCCESS) {
+        return_code = load_temperature_correction(arg_temp_file_ptr, set_id);
+    }
+    if (return_code == SUCCESS) {
+        return_code = load_nconductor_factor(arg_ncond_file_ptr, set_id);
+    }
+    if (return_code == SUCCESS) {
+        return_code = load_conduit_fill_data(arg_conduit_file_ptr, set_id);
+    }
+    if (return_code != SUCCESS) {
+        return return_code;
+    }
+
+    g_table_set_count++;
+    return set_id;
+}
+
+// Table set id from its name (NOM, NEC, IEC...)
+int get_table_set_id(const char *arg_set_name_ptr){
+    for (int i = 0; i < g_table_set_count; i++){
+        if (strcasecmp(g_table_set_g_list[i].sts_name, arg_set_name_ptr) == 0){
+            return i;
+        }
+    }
+    return ERROR_DATA_NOT_FOUND;
+}
+
 // Ampacity CSV File
-int load_ampacity_table_data(const char *arg_file_name_ptr) {
+int load_ampacity_table_data(const char *arg_file_name_ptr, int arg_set_id) {
     FILE *file_ptr = fopen(arg_file_name_ptr,"r");
     if (!file_ptr){
-        REPORT_ERROR("Failed to open ampacity_data.csv");
+        REPORT_ERROR("Failed to open ampacity data file.");
         return ERROR_FILE_OPEN;
     }
 
     char line[128]; // Increased buffer size for safety, 32 might be too small for some lines/paths
     fgets(line, sizeof(line),file_ptr); // Skip header
 
-    g_conductor_count = 0;
-    while (fgets(line, sizeof(line), file_ptr) != NULL && g_conductor_count < 20){
+    int first = g_conductor_count;
+    g_table_set_g_list[arg_set_id].sts_conductor_first = first;
+    while (fgets(line, sizeof(line), file_ptr) != NULL && g_conductor_count - first < MAX_CONDUCTORS_PER_SET){
         // Use a temporary buffer for strtok as it modifies the string -> Recommended in Clion
         char temp_line[256];
         strcpy(temp_line, line); // Copy the line to a temporary buffer
@@ -402,27 +583,36 @@ int load_ampacity_table_data(const char *arg_file_name_ptr) {
             fclose(file_ptr);
             return ERROR_INVALID_INPUT;
         }
+        // Checked once here so the voltage drop of every row can not fail later
+        if (!isfinite(g_conductor_data_g_list[g_conductor_count].sc_resistance_km) || g_conductor_data_g_list[g_conductor_count].sc_resistance_km < 0 ||
+            !isfinite(g_conductor_data_g_list[g_conductor_count].sc_reactance_km) || g_conductor_data_g_list[g_conductor_count].sc_reactance_km < 0) {
+            REPORT_ERROR("Invalid value in ampacity_data.csv: Resistance and reactance must be non-negative numbers.");
+            fclose(file_ptr);
+            return ERROR_INVALID_INPUT;
+        }
         g_conductor_count++;
     }
 
     fclose(file_ptr);
-    printf("Action: Loaded %d ampacity data entries from %s.\n", g_conductor_count, arg_file_name_ptr);
+    g_table_set_g_list[arg_set_id].sts_conductor_count = g_conductor_count - first;
+    printf("Action: Loaded %d ampacity data entries from %s.\n", g_conductor_count - first, arg_file_name_ptr);
     return SUCCESS;
 }
 
 // Temperature Corection Factor CSV File
-int load_temperature_correction(const char *arg_file_name_ptr){
+int load_temperature_correction(const char *arg_file_name_ptr, int arg_set_id){
     FILE *file_ptr = fopen(arg_file_name_ptr, "r");
     if (!file_ptr){
-        REPORT_ERROR("Error opening temp_correction_data.csv\n");
+        REPORT_ERROR("Error opening temperature correction data file.");
         return ERROR_FILE_OPEN;
     }
 
     char line[128]; // Limit for each line.
     fgets(line, sizeof(line), file_ptr);
 
-    g_temp_correction_count = 0;
-    while(fgets(line, sizeof(line), file_ptr) && g_temp_correction_count < 20){ // 20 is the max number of correction factors
+    int first = g_temp_correction_count;
+    g_table_set_g_list[arg_set_id].sts_temp_first = first;
+    while(fgets(line, sizeof(line), file_ptr) && g_temp_correction_count - first < MAX_TEMP_FACTORS_PER_SET){ // 20 is the max number of correction factors
         char *token;
         token = strtok(line, ",");
         if (token){
@@ -437,27 +627,30 @@ int load_temperature_correction(const char *arg_file_name_ptr){
             g_temp_factors_g_list[g_temp_correction_count].stc_correction_factor = atof(token);
         } else {
             REPORT_ERROR("Invalid format in temp_correction_data.csv: Correction factor not found.");
+            fclose(file_ptr);
             return ERROR_INVALID_INPUT;
         }
         g_temp_correction_count++;
     }
     fclose(file_ptr);
-    printf("Action: Loaded %d temperature correction factors from %s.\n", g_temp_correction_count, arg_file_name_ptr);
+    g_table_set_g_list[arg_set_id].sts_temp_count = g_temp_correction_count - first;
+    printf("Action: Loaded %d temperature correction factors from %s.\n", g_temp_correction_count - first, arg_file_name_ptr);
     return SUCCESS;
 }
 
 // Conduit fill data CSV
-int load_conduit_fill_data(const char *arg_file_name_ptr){
+int load_conduit_fill_data(const char *arg_file_name_ptr, int arg_set_id){
     FILE *file_ptr = fopen(arg_file_name_ptr, "r");
     if(!file_ptr){
-        REPORT_ERROR("Error loading conduit_fill_data.csv\n");
+        REPORT_ERROR("Error loading conduit fill data file.");
         return ERROR_FILE_OPEN;
     }
     char line[128];
     fgets(line, sizeof(line), file_ptr);
 
-    g_conduit_count = 0;
-    while(fgets(line, sizeof(line), file_ptr) && g_conduit_count < 30){
+    int first = g_conduit_count;
+    g_table_set_g_list[arg_set_id].sts_conduit_first = first;
+    while(fgets(line, sizeof(line), file_ptr) && g_conduit_count - first < MAX_CONDUITS_PER_SET){
         char *token;
         token = strtok(line, ",");
         if(token){
@@ -486,21 +679,23 @@ int load_conduit_fill_data(const char *arg_file_name_ptr){
         g_conduit_count++;
     }
     fclose(file_ptr);
-    printf("Action: Loaded %d conduit fill data entries from %s. \n", g_conduit_count,arg_file_name_ptr);
+    g_table_set_g_list[arg_set_id].sts_conduit_count = g_conduit_count - first;
+    printf("Action: Loaded %d conduit fill data entries from %s. \n", g_conduit_count - first, arg_file_name_ptr);
     return SUCCESS;
 }
 
 // Number of conductors, correction factor
-int load_nconductor_factor(const char *arg_file_name_ptr){
+int load_nconductor_factor(const char *arg_file_name_ptr, int arg_set_id){
     FILE *file_ptr = fopen(arg_file_name_ptr, "r");
     if (!file_ptr) {
-        REPORT_ERROR("Error opening num_cond_ad_data.csv\n");
+        REPORT_ERROR("Error opening number of conductors adjustment data file.");
         return ERROR_FILE_OPEN;
     }
     char line[100];
     fgets(line, sizeof(line), file_ptr); // Skip header
-    g_ncond_adj_count = 0;
-    while (fgets(line, sizeof(line), file_ptr) && g_ncond_adj_count < 20) {
+    int first = g_ncond_adj_count;
+    g_table_set_g_list[arg_set_id].sts_ncond_first = first;
+    while (fgets(line, sizeof(line), file_ptr) && g_ncond_adj_count - first < MAX_NCOND_FACTORS_PER_SET) {
         char *token;
         token = strtok(line, ",");
         if (token) {
@@ -521,7 +716,8 @@ int load_nconductor_factor(const char *arg_file_name_ptr){
         g_ncond_adj_count++;
     }
     fclose(file_ptr);
-    printf("Action: Loaded %d number of conductors adjustment factors from %s.\n", g_ncond_adj_count, arg_file_name_ptr);
+    g_table_set_g_list[arg_set_id].sts_ncond_count = g_ncond_adj_count - first;
+    printf("Action: Loaded %d number of conductors adjustment factors from %s.\n", g_ncond_adj_count - first, arg_file_name_ptr);
     return SUCCESS;
 }
 
@@ -550,14 +746,15 @@ float calculate_adjusted_current_amps(float arg_load_current_amps, float arg_tem
 }
 
 // Suggested gauge only using the adjustmen current
-int get_suggested_gauge_awg_kcmil(float arg_adjusted_current_amps,const char *arg_insulation_type_ptr, int arg_temp_rating){
-    printf("Action: Getting suggested gauge for %.2f Amps with insulation %s and temperature rating %dC.\n", arg_adjusted_current_amps, arg_insulation_type_ptr, arg_temp_rating);
+int get_suggested_gauge_awg_kcmil(int arg_set_id, float arg_adjusted_current_amps,const char *arg_insulation_type_ptr, int arg_temp_rating){
+    (void)arg_insulation_type_ptr; // Ampacity tables are per set, insulation type does not filter rows yet
 
     if (arg_adjusted_current_amps <=0){
         REPORT_ERROR("Adjusted current must be positive to find a gauge.");
         return ERROR_INVALID_INPUT;
     }
-    for (int i = 0; i < g_conductor_count; i++){
+    const TableSet *set_ptr = &g_table_set_g_list[arg_set_id];
+    for (int i = set_ptr->sts_conductor_first; i < set_ptr->sts_conductor_first + set_ptr->sts_conductor_count; i++){
             float ampacity_to_check;
             if (arg_temp_rating == 90) {
                 ampacity_to_check = g_conductor_data_g_list[i].sc_ampacity_at_90c_amps;
@@ -574,8 +771,9 @@ int get_suggested_gauge_awg_kcmil(float arg_adjusted_current_amps,const char *ar
 }
 
 // Temperature correction factors based on the ambient temp
-float get_temp_correction_factor(int arg_ambient_temp){
-    for (int i = 0; i < g_temp_correction_count; i++){
+float get_temp_correction_factor(int arg_set_id, int arg_ambient_temp){
+    const TableSet *set_ptr = &g_table_set_g_list[arg_set_id];
+    for (int i = set_ptr->sts_temp_first; i < set_ptr->sts_temp_first + set_ptr->sts_temp_count; i++){
         if (g_temp_factors_g_list[i].stc_ambient_temp == arg_ambient_temp){
             return g_temp_factors_g_list[i].stc_correction_factor;
         }
@@ -585,8 +783,9 @@ float get_temp_correction_factor(int arg_ambient_temp){
 }
 
 // Number of conductors factors based on user´s input
-float get_ncond_adj_factor(int arg_conductor_count){
-    for (int i = 0; i < g_ncond_adj_count; i++){
+float get_ncond_adj_factor(int arg_set_id, int arg_conductor_count){
+    const TableSet *set_ptr = &g_table_set_g_list[arg_set_id];
+    for (int i = set_ptr->sts_ncond_first; i < set_ptr->sts_ncond_first + set_ptr->sts_ncond_count; i++){
         if (g_ncond_adj_g_list[i].snca_conductor_count == arg_conductor_count){
             return g_ncond_adj_g_list[i].snca_adjustment_factor;
         }
@@ -595,8 +794,9 @@ float get_ncond_adj_factor(int arg_conductor_count){
     return (float)ERROR_DATA_NOT_FOUND;
 }
 // Resistance for the conductor calculated
-float get_conductor_resistance_km(int arg_gauge_awg_kcmil) {
-    for (int i = 0; i < g_conductor_count; i++) {
+float get_conductor_resistance_km(int arg_set_id, int arg_gauge_awg_kcmil) {
+    const TableSet *set_ptr = &g_table_set_g_list[arg_set_id];
+    for (int i = set_ptr->sts_conductor_first; i < set_ptr->sts_conductor_first + set_ptr->sts_conductor_count; i++) {
         if (g_conductor_data_g_list[i].sc_gauge_awg_kcmil == arg_gauge_awg_kcmil) {
             return g_conductor_data_g_list[i].sc_resistance_km;
         }
@@ -605,8 +805,9 @@ float get_conductor_resistance_km(int arg_gauge_awg_kcmil) {
     return (float)ERROR_DATA_NOT_FOUND;
 }
 // Reactance for the conductor calculated
-float get_conductor_reactance_km(int arg_gauge_awg_kcmil) {
-    for (int i = 0; i < g_conductor_count; i++) {
+float get_conductor_reactance_km(int arg_set_id, int arg_gauge_awg_kcmil) {
+    const TableSet *set_ptr = &g_table_set_g_list[arg_set_id];
+    for (int i = set_ptr->sts_conductor_first; i < set_ptr->sts_conductor_first + set_ptr->sts_conductor_count; i++) {
         if (g_conductor_data_g_list[i].sc_gauge_awg_kcmil == arg_gauge_awg_kcmil) {
             return g_conductor_data_g_list[i].sc_reactance_km;
         }
@@ -615,8 +816,9 @@ float get_conductor_reactance_km(int arg_gauge_awg_kcmil) {
     return (float)ERROR_DATA_NOT_FOUND;
 }
 // Area in mm2 for the conductor calculated
-float get_conductor_mm2(int arg_gauge_awg_kcmil) {
-    for (int i = 0; i < g_conductor_count; i++) {
+float get_conductor_mm2(int arg_set_id, int arg_gauge_awg_kcmil) {
+    const TableSet *set_ptr = &g_table_set_g_list[arg_set_id];
+    for (int i = set_ptr->sts_conductor_first; i < set_ptr->sts_conductor_first + set_ptr->sts_conductor_count; i++) {
         if (g_conductor_data_g_list[i].sc_gauge_awg_kcmil == arg_gauge_awg_kcmil) {
             return g_conductor_data_g_list[i].sc_area_mm2;
         }
@@ -649,8 +851,9 @@ float calculate_voltage_drop_volts(float arg_load_current_amps, float arg_circui
 }
 
 // Conduit area based on user input
-float get_conduit_area(const char *arg_conduit_type_ptr, float arg_conduit_diameter_nominal_inches) {
-    for (int i = 0; i < g_conduit_count; i++) {
+float get_conduit_area(int arg_set_id, const char *arg_conduit_type_ptr, float arg_conduit_diameter_nominal_inches) {
+    const TableSet *set_ptr = &g_table_set_g_list[arg_set_id];
+    for (int i = set_ptr->sts_conduit_first; i < set_ptr->sts_conduit_first + set_ptr->sts_conduit_count; i++) {
         if (strcasecmp(g_conduit_data_g_list[i].sc_conduit_type, arg_conduit_type_ptr) == 0 &&
             fabs(g_conduit_data_g_list[i].sc_diameter_inches - arg_conduit_diameter_nominal_inches) < 0.001) {
             return g_conduit_data_g_list[i].sc_internal_area_mm2;
@@ -661,14 +864,14 @@ float get_conduit_area(const char *arg_conduit_type_ptr, float arg_conduit_diame
 }
 
 // Check conduit fill
-int check_conduit_fill(float arg_conductor_area, int arg_conductor_count, const char *arg_conduit_type_ptr, float arg_conduit_diameter_nominal_inches){
+int check_conduit_fill(int arg_set_id, float arg_conductor_area, int arg_conductor_count, const char *arg_conduit_type_ptr, float arg_conduit_diameter_nominal_inches){
     if (arg_conductor_area <= 0 || arg_conductor_count <= 0) {
         REPORT_ERROR("Conductor area and count must be positive for fill check.");
         return ERROR_INVALID_INPUT;
     }
 
     float local_total_conductor_area = arg_conductor_area * arg_conductor_count;
-    float local_conduit_area = get_conduit_area(arg_conduit_type_ptr, arg_conduit_diameter_nominal_inches);
+    float local_conduit_area = get_conduit_area(arg_set_id, arg_conduit_type_ptr, arg_conduit_diameter_nominal_inches);
 
     if (local_conduit_area < 0) {
         return (int)local_conduit_area;
@@ -681,11 +884,364 @@ int check_conduit_fill(float arg_conductor_area, int arg_conductor_count, const
     printf("Conduit internal area: %.2f mm²\n", local_conduit_area);
     printf("Conduit fill percentage: %.2f%%\n", local_fill_percentage);
 
-    if (local_fill_percentage <= 40.0f) {
-        printf("RESULT: The conduit fill of %.2f%% is within the acceptable limit (40%%).\n", local_fill_percentage);
+    if (local_fill_percentage <= MAX_CONDUIT_FILL_PERCENT) {
+        printf("RESULT: The conduit fill of %.2f%% is within the acceptable limit (%.0f%%).\n", local_fill_percentage, MAX_CONDUIT_FILL_PERCENT);
         return SUCCESS;
     } else {
-        printf("WARNING: The conduit fill of %.2f%% exceeds the recommended 40%% limit. A larger conduit may be required.\n", local_fill_percentage);
+        printf("WARNING: The conduit fill of %.2f%% exceeds the recommended %.0f%% limit. A larger conduit may be required.\n", local_fill_percentage, MAX_CONDUIT_FILL_PERCENT);
         return ERROR_INVALID_INPUT;
     }
+}
+
+// Gauge label for printing (110..140 are 1/0..4/0 AWG, 250 and up are kcmil)
+const char *format_gauge_awg_kcmil(int arg_gauge_awg_kcmil, char *arg_buffer_ptr, size_t arg_buffer_size){
+    if (arg_gauge_awg_kcmil >= 110 && arg_gauge_awg_kcmil <= 140) {
+        snprintf(arg_buffer_ptr, arg_buffer_size, "%d/0 AWG", (arg_gauge_awg_kcmil - 100) / 10);
+    } else if (arg_gauge_awg_kcmil >= 250) {
+        snprintf(arg_buffer_ptr, arg_buffer_size, "%d kcmil", arg_gauge_awg_kcmil);
+    } else {
+        snprintf(arg_buffer_ptr, arg_buffer_size, "%d AWG", arg_gauge_awg_kcmil);
+    }
+    return arg_buffer_ptr;
+}
+
+// Batch CSV: Label,Standard,PowerW,VoltageV,PowerFactor,Phases,LengthM,AmbientC,ConductorCount,Insulation,TempRating,ConduitType,ConduitDiameterIn
+// Standard is a table set name, or ALL to size the circuit with every loaded set in the same pass.
+int run_circuit_batch(const char *arg_input_file_ptr, const char *arg_report_file_ptr){
+    FILE *file_ptr = fopen(arg_input_file_ptr, "r");
+    if (!file_ptr){
+        REPORT_ERROR("Failed to open circuit batch file.");
+        return ERROR_FILE_OPEN;
+    }
+    FILE *report_ptr = fopen(arg_report_file_ptr, "w"); // Own file, the console also gets the progress lines
+    if (!report_ptr){
+        REPORT_ERROR("Failed to open report file.");
+        fclose(file_ptr);
+        return ERROR_FILE_OPEN;
+    }
+
+    char line[512];
+    fgets(line, sizeof(line), file_ptr); // Skip header
+    fprintf(report_ptr, "Label,Standard,LoadCurrentA,AdjustedCurrentA,Gauge,VoltageDropV,VoltageDropPct,ConduitFillPct,Status\n");
+
+    int circuit_count = 0;
+    int evaluation_count = 0;
+    int skipped_count = 0;
+    while (fgets(line, sizeof(line), file_ptr)){
+        CircuitRecord record;
+        char set_name[16];
+
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '\0') {
+            continue; // Blank line
+        }
+        if (sscanf(line, "%31[^,],%15[^,],%f,%f,%f,%d,%f,%d,%d,%31[^,],%d,%31[^,],%f",
+                   record.scr_label, set_name, &record.scr_power_watts, &record.scr_voltage_volts, &record.scr_power_factor,
+                   &record.scr_phase_count, &record.scr_circuit_length_meters, &record.scr_ambient_temperature,
+                   &record.scr_conductor_count, record.scr_insulation_type, &record.scr_temp_rating,
+                   record.scr_conduit_type, &record.scr_conduit_diameter) != 13){
+            REPORT_ERROR("Invalid format in circuit batch file, line skipped.");
+            skipped_count++;
+            continue;
+        }
+
+        // Same checks as the interactive prompts
+        if (!isfinite(record.scr_power_watts) || !isfinite(record.scr_voltage_volts) || !isfinite(record.scr_power_factor) ||
+            !isfinite(record.scr_circuit_length_meters) || !isfinite(record.scr_conduit_diameter)){
+            REPORT_ERROR("Non numeric (nan or inf) value in circuit batch file, line skipped.");
+            skipped_count++;
+            continue;
+        }
+        if (record.scr_power_watts <= 0 || record.scr_voltage_volts <= 0 || record.scr_power_factor <= 0 || record.scr_power_factor > 1 ||
+            record.scr_circuit_length_meters < 0 || record.scr_conduit_diameter <= 0){
+            REPORT_ERROR("Power, voltage and conduit diameter must be positive, power factor between 0 and 1 and length not negative, line skipped.");
+            skipped_count++;
+            continue;
+        }
+        if (record.scr_temp_rating != 75 && record.scr_temp_rating != 90){
+            REPORT_ERROR("Insulation temperature rating must be 75 or 90, line skipped.");
+            skipped_count++;
+            continue;
+        }
+
+        // The set name is resolved once here, evaluation only works with the set id
+        if (strcasecmp(set_name, "ALL") == 0){
+            record.scr_table_set_id = TABLE_SET_ALL;
+        } else {
+            record.scr_table_set_id = get_table_set_id(set_name);
+            if (record.scr_table_set_id < 0){
+                REPORT_ERROR("Unknown standard in circuit batch file, line skipped.");
+                skipped_count++;
+                continue;
+            }
+        }
+
+        if (record.scr_table_set_id == TABLE_SET_ALL){
+            for (int set_id = 0; set_id < g_table_set_count; set_id++){
+                evaluate_circuit_record(&record, set_id, report_ptr);
+                evaluation_count++;
+            }
+        } else {
+            evaluate_circuit_record(&record, record.scr_table_set_id, report_ptr);
+            evaluation_count++;
+        }
+        circuit_count++;
+    }
+    fclose(file_ptr);
+    fclose(report_ptr);
+
+    printf("Action: Evaluated %d circuits (%d evaluations, %d lines skipped) from %s.\n", circuit_count, evaluation_count, skipped_count, arg_input_file_ptr);
+    return SUCCESS;
+}
+
+// Size one circuit with one table set and write a report row
+int evaluate_circuit_record(const CircuitRecord *arg_record_ptr, int arg_set_id, FILE *arg_report_ptr){
+    const char *set_name_ptr = g_table_set_g_list[arg_set_id].sts_name;
+    char gauge_label[24];
+
+    float load_current_amps = calculate_load_current_amps(arg_record_ptr->scr_power_watts, arg_record_ptr->scr_voltage_volts, arg_record_ptr->scr_power_factor, arg_record_ptr->scr_phase_count);
+    if (load_current_amps < 0){
+        fprintf(arg_report_ptr, "%s,%s,,,,,,,ERROR_LOAD_CURRENT\n", arg_record_ptr->scr_label, set_name_ptr);
+        return (int)load_current_amps;
+    }
+    float temp_correction_factor = get_temp_correction_factor(arg_set_id, arg_record_ptr->scr_ambient_temperature);
+    float num_cond_adjustment_factor = get_ncond_adj_factor(arg_set_id, arg_record_ptr->scr_conductor_count);
+    if (temp_correction_factor < 0 || num_cond_adjustment_factor < 0){
+        fprintf(arg_report_ptr, "%s,%s,%.2f,,,,,,ERROR_FACTOR_NOT_FOUND\n", arg_record_ptr->scr_label, set_name_ptr, load_current_amps);
+        return ERROR_DATA_NOT_FOUND;
+    }
+    float adjusted_current_amps = calculate_adjusted_current_amps(load_current_amps, temp_correction_factor, num_cond_adjustment_factor);
+    if (adjusted_current_amps < 0){
+        fprintf(arg_report_ptr, "%s,%s,%.2f,,,,,,ERROR_ADJUSTED_CURRENT\n", arg_record_ptr->scr_label, set_name_ptr, load_current_amps);
+        return (int)adjusted_current_amps;
+    }
+    int gauge_awg_kcmil = get_suggested_gauge_awg_kcmil(arg_set_id, adjusted_current_amps, arg_record_ptr->scr_insulation_type, arg_record_ptr->scr_temp_rating);
+    if (gauge_awg_kcmil < 0){
+        fprintf(arg_report_ptr, "%s,%s,%.2f,%.2f,,,,,ERROR_NO_GAUGE\n", arg_record_ptr->scr_label, set_name_ptr, load_current_amps, adjusted_current_amps);
+        return gauge_awg_kcmil;
+    }
+    format_gauge_awg_kcmil(gauge_awg_kcmil, gauge_label, sizeof(gauge_label));
+
+    float conductor_area = get_conductor_mm2(arg_set_id, gauge_awg_kcmil);
+    float conductor_resistance = get_conductor_resistance_km(arg_set_id, gauge_awg_kcmil);
+    float conductor_reactance = get_conductor_reactance_km(arg_set_id, gauge_awg_kcmil);
+    float voltage_drop_volts = calculate_voltage_drop_volts(load_current_amps, arg_record_ptr->scr_circuit_length_meters, conductor_resistance, conductor_reactance, arg_record_ptr->scr_power_factor, arg_record_ptr->scr_phase_count);
+    if (voltage_drop_volts < 0){
+        fprintf(arg_report_ptr, "%s,%s,%.2f,%.2f,%s,,,,ERROR_VOLTAGE_DROP\n", arg_record_ptr->scr_label, set_name_ptr, load_current_amps, adjusted_current_amps, gauge_label);
+        return (int)voltage_drop_volts;
+    }
+    float voltage_drop_percent = voltage_drop_volts / arg_record_ptr->scr_voltage_volts * 100.0f;
+
+    float conduit_area = get_conduit_area(arg_set_id, arg_record_ptr->scr_conduit_type, arg_record_ptr->scr_conduit_diameter);
+    if (conduit_area < 0){
+        fprintf(arg_report_ptr, "%s,%s,%.2f,%.2f,%s,%.2f,%.2f,,ERROR_CONDUIT_NOT_FOUND\n", arg_record_ptr->scr_label, set_name_ptr, load_current_amps, adjusted_current_amps, gauge_label, voltage_drop_volts, voltage_drop_percent);
+        return ERROR_DATA_NOT_FOUND;
+    }
+    float fill_percent = conductor_area * arg_record_ptr->scr_conductor_count / conduit_area * 100.0f;
+
+    const char *status_ptr = "OK";
+    if (voltage_drop_percent > MAX_VOLTAGE_DROP_PERCENT && fill_percent > MAX_CONDUIT_FILL_PERCENT) {
+        status_ptr = "WARNING_VOLTAGE_DROP_AND_FILL";
+    } else if (voltage_drop_percent > MAX_VOLTAGE_DROP_PERCENT) {
+        status_ptr = "WARNING_VOLTAGE_DROP";
+    } else if (fill_percent > MAX_CONDUIT_FILL_PERCENT) {
+        status_ptr = "WARNING_FILL";
+    }
+    fprintf(arg_report_ptr, "%s,%s,%.2f,%.2f,%s,%.2f,%.2f,%.2f,%s\n", arg_record_ptr->scr_label, set_name_ptr, load_current_amps, adjusted_current_amps, gauge_label, voltage_drop_volts, voltage_drop_percent, fill_percent, status_ptr);
+    return SUCCESS;
+}
+
+// Energy loss CSV: Label,Standard,VoltageV,PowerFactor,Phases,LengthM,P1,P2,...,P8760 (hourly power in watts)
+// Each line is reduced once (sum of P^2 and peak |P|) and every gauge of the set reuses that result.
+int run_energy_loss_batch(const char *arg_input_file_ptr, const char *arg_report_file_ptr){
+    FILE *file_ptr = fopen(arg_input_file_ptr, "r");
+    if (!file_ptr){
+        REPORT_ERROR("Failed to open load profiles file.");
+        return ERROR_FILE_OPEN;
+    }
+    FILE *report_ptr = fopen(arg_report_file_ptr, "w"); // Own file, the console also gets the progress lines
+    if (!report_ptr){
+        REPORT_ERROR("Failed to open report file.");
+        fclose(file_ptr);
+        return ERROR_FILE_OPEN;
+    }
+
+    char *line_ptr = NULL; // Grows to the longest profile line, 8760 values do not fit in a fixed buffer
+    size_t line_capacity = 0;
+    float block[ENERGY_BLOCK_HOURS];
+
+    int read_code = read_long_line(file_ptr, &line_ptr, &line_capacity); // Skip header
+    fprintf(report_ptr, "Label,Standard,Gauge,AnnualLossKWh,PeakCurrentA,PeakVoltageDropV,PeakVoltageDropPct\n");
+
+    int circuit_count = 0;
+    int skipped_count = 0;
+    long long evaluation_count = 0; // Profile hours times gauges
+    while (read_code == SUCCESS && (read_code = read_long_line(file_ptr, &line_ptr, &line_capacity)) == SUCCESS){
+        char label[32];
+        char set_name[16];
+        float voltage_volts;
+        float power_factor;
+        int phase_count;
+        float circuit_length_meters;
+        int offset = 0;
+
+        line_ptr[strcspn(line_ptr, "\r\n")] = '\0';
+        if (line_ptr[0] == '\0') {
+            continue; // Blank line
+        }
+        if (sscanf(line_ptr, "%31[^,],%15[^,],%f,%f,%d,%f%n", label, set_name, &voltage_volts, &power_factor, &phase_count, &circuit_length_meters, &offset) != 6){
+            REPORT_ERROR("Invalid format in load profiles file, line skipped.");
+            skipped_count++;
+            continue;
+        }
+        int set_id = TABLE_SET_ALL;
+        if (strcasecmp(set_name, "ALL") != 0){
+            set_id = get_table_set_id(set_name);
+            if (set_id < 0){
+                REPORT_ERROR("Unknown standard in load profiles file, line skipped.");
+                skipped_count++;
+                continue;
+            }
+        }
+        if (!isfinite(voltage_volts) || !isfinite(power_factor) || !isfinite(circuit_length_meters) ||
+            voltage_volts <= 0 || power_factor <= 0 || power_factor > 1 || circuit_length_meters < 0){
+            REPORT_ERROR("Voltage must be a positive number, power factor between 0 and 1 and length a non-negative number, line skipped.");
+            skipped_count++;
+            continue;
+        }
+        float amps_per_watt = calculate_load_current_amps(1.0f, voltage_volts, power_factor, phase_count);
+        if (amps_per_watt < 0){
+            REPORT_ERROR("Load current could not be calculated for the load profile, line skipped.");
+            skipped_count++;
+            continue;
+        }
+
+        // Stream the hourly values through a cache sized block
+        LoadProfileSummary summary = {0.0, 0.0f, 0};
+        int block_count = 0;
+        char *cursor_ptr = line_ptr + offset;
+        while (*cursor_ptr == ','){
+            char *end_ptr;
+            block[block_count] = strtof(cursor_ptr + 1, &end_ptr);
+            if (end_ptr == cursor_ptr + 1 || !isfinite(block[block_count])){
+                break; // Empty, non numeric, nan or inf value
+            }
+            cursor_ptr = end_ptr;
+            if (++block_count == ENERGY_BLOCK_HOURS){
+                reduce_load_profile_block(block, block_count, &summary);
+                block_count = 0;
+            }
+        }
+        reduce_load_profile_block(block, block_count, &summary);
+        if (*cursor_ptr != '\0' || summary.slps_hour_count == 0 || !isfinite(summary.slps_sum_power_sq)){
+            REPORT_ERROR("Invalid hourly value in load profiles file, line skipped.");
+            skipped_count++;
+            continue;
+        }
+        if (summary.slps_hour_count != HOURS_PER_YEAR && summary.slps_hour_count != HOURS_PER_LEAP_YEAR){
+            REPORT_ERROR("Load profile must have 8760 (or 8784) hourly values, line skipped.");
+            skipped_count++;
+            continue;
+        }
+
+        int evaluate_code = SUCCESS;
+        long long circuit_evaluations = 0;
+        for (int i = (set_id == TABLE_SET_ALL ? 0 : set_id); i < (set_id == TABLE_SET_ALL ? g_table_set_count : set_id + 1) && evaluate_code == SUCCESS; i++){
+            evaluate_code = evaluate_energy_loss(label, i, &summary, amps_per_watt, voltage_volts, power_factor, phase_count, circuit_length_meters, report_ptr);
+            circuit_evaluations += (long long)summary.slps_hour_count * g_table_set_g_list[i].sts_conductor_count;
+        }
+        if (evaluate_code != SUCCESS){
+            REPORT_ERROR("Energy loss could not be evaluated for the load profile, line skipped.");
+            skipped_count++;
+            continue;
+        }
+        evaluation_count += circuit_evaluations;
+        circuit_count++;
+    }
+    free(line_ptr);
+    fclose(file_ptr);
+    fclose(report_ptr);
+    if (read_code == ERROR_OUT_OF_MEMORY){
+        return ERROR_OUT_OF_MEMORY;
+    }
+
+    printf("Action: Evaluated %d load profiles (%lld profile-gauge hours, %d lines skipped) from %s.\n", circuit_count, evaluation_count, skipped_count, arg_input_file_ptr);
+    return SUCCESS;
+}
+
+// fgets for lines of any length, the buffer is reallocated as needed and reused between calls
+int read_long_line(FILE *arg_file_ptr, char **arg_buffer_ptr, size_t *arg_capacity_ptr){
+    if (*arg_buffer_ptr == NULL){
+        *arg_capacity_ptr = 4096;
+        *arg_buffer_ptr = malloc(*arg_capacity_ptr);
+        if (*arg_buffer_ptr == NULL){
+            REPORT_ERROR("Out of memory reading line.");
+            return ERROR_OUT_OF_MEMORY;
+        }
+    }
+    size_t length = 0;
+    while (fgets(*arg_buffer_ptr + length, (int)(*arg_capacity_ptr - length), arg_file_ptr)){
+        size_t read_length = strlen(*arg_buffer_ptr + length);
+        if (read_length == 0){
+            return SUCCESS; // Line starting with '\0', the caller sees it as blank
+        }
+        length += read_length;
+        if ((*arg_buffer_ptr)[length - 1] == '\n' || length + 1 < *arg_capacity_ptr){
+            return SUCCESS; // Whole line, or last line without '\n'
+        }
+        char *new_buffer_ptr = realloc(*arg_buffer_ptr, *arg_capacity_ptr * 2);
+        if (new_buffer_ptr == NULL){
+            REPORT_ERROR("Out of memory reading line.");
+            return ERROR_OUT_OF_MEMORY;
+        }
+        *arg_buffer_ptr = new_buffer_ptr;
+        *arg_capacity_ptr *= 2;
+    }
+    return length > 0 ? SUCCESS : ERROR_DATA_NOT_FOUND;
+}
+
+// Sum of squares and peak of a block of hourly values.
+// Compiled with -DWIRING_SIMD -fopenmp-simd the loop is a SIMD reduction (one multiply-add and one max per vector of hours).
+void reduce_load_profile_block(const float *arg_block_ptr, int arg_count, LoadProfileSummary *arg_summary_ptr){
+    float block_sum = 0.0f;
+    float block_peak = 0.0f;
+#ifdef WIRING_SIMD
+    #pragma omp simd reduction(+:block_sum) reduction(max:block_peak)
+#endif
+    for (int i = 0; i < arg_count; i++){
+        float value = fabsf(arg_block_ptr[i]);
+        block_sum += value * value;
+        block_peak = value > block_peak ? value : block_peak;
+    }
+
+    // Block totals go to double so 8760 hours do not lose precision
+    arg_summary_ptr->slps_sum_power_sq += block_sum;
+    if (block_peak > arg_summary_ptr->slps_peak_power_watts){
+        arg_summary_ptr->slps_peak_power_watts = block_peak;
+    }
+    arg_summary_ptr->slps_hour_count += arg_count;
+}
+
+// Annual I^2R loss and peak voltage drop of one profile for every gauge row of a table set
+int evaluate_energy_loss(const char *arg_label_ptr, int arg_set_id, const LoadProfileSummary *arg_summary_ptr, float arg_amps_per_watt, float arg_voltage_volts, float arg_power_factor, int arg_phase_count, float arg_circuit_length_meters, FILE *arg_report_ptr){
+    const TableSet *set_ptr = &g_table_set_g_list[arg_set_id];
+    char gauge_label[24];
+
+    int loaded_conductors = (arg_phase_count == 3) ? 3 : 2; // Conductors carrying the load current
+    double sum_current_sq = arg_summary_ptr->slps_sum_power_sq * arg_amps_per_watt * arg_amps_per_watt; // A^2 * h
+    float peak_current_amps = arg_summary_ptr->slps_peak_power_watts * arg_amps_per_watt;
+    double circuit_length_km = arg_circuit_length_meters / 1000.0;
+
+    for (int i = set_ptr->sts_conductor_first; i < set_ptr->sts_conductor_first + set_ptr->sts_conductor_count; i++){
+        const Conductor *conductor_ptr = &g_conductor_data_g_list[i];
+        double loss_kwh = loaded_conductors * conductor_ptr->sc_resistance_km * circuit_length_km * sum_current_sq / 1000.0;
+        float voltage_drop_volts = calculate_voltage_drop_volts(peak_current_amps, arg_circuit_length_meters, conductor_ptr->sc_resistance_km, conductor_ptr->sc_reactance_km, arg_power_factor, arg_phase_count);
+        if (voltage_drop_volts < 0){
+            return (int)voltage_drop_volts;
+        }
+        fprintf(arg_report_ptr, "%s,%s,%s,%.3f,%.2f,%.3f,%.3f\n", arg_label_ptr, set_ptr->sts_name,
+                format_gauge_awg_kcmil(conductor_ptr->sc_gauge_awg_kcmil, gauge_label, sizeof(gauge_label)),
+                loss_kwh, peak_current_amps, voltage_drop_volts, voltage_drop_volts / arg_voltage_volts * 100.0f);
+    }
+    return SUCCESS;
 }
\ No newline at end of file